@@ -24,10 +24,20 @@ typedef enum {
 	FU_CONTEXT_HWID_FLAG_LOAD_ALL = G_MAXUINT,
 } FuContextHwidFlags;
 
+typedef void (*FuContextHousekeepingFunc)(FuContext *self, gpointer user_data);
+
 FuContext *
 fu_context_new(void);
 void
 fu_context_housekeeping(FuContext *self) G_GNUC_NON_NULL(1);
+void
+fu_context_add_housekeeping_func(FuContext *self,
+				 FuContextHousekeepingFunc func,
+				 gpointer user_data) G_GNUC_NON_NULL(1, 2);
+void
+fu_context_remove_housekeeping_func(FuContext *self,
+				    FuContextHousekeepingFunc func,
+				    gpointer user_data) G_GNUC_NON_NULL(1, 2);
 gboolean
 fu_context_reload_bios_settings(FuContext *self, GError **error);
 gboolean
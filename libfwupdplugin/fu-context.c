@@ -8,7 +8,12 @@
 
 #include "config.h"
 
+#include <glib/gstdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "fu-bios-settings-private.h"
+#include "fu-bytes.h"
 #include "fu-common-private.h"
 #include "fu-config-private.h"
 #include "fu-context-helper.h"
@@ -19,6 +24,7 @@
 #include "fu-efi-hard-drive-device-path.h"
 #include "fu-fdt-firmware.h"
 #include "fu-hwids-private.h"
+#include "fu-mem.h"
 #include "fu-path.h"
 #include "fu-pefile-firmware.h"
 #include "fu-volume-private.h"
@@ -31,28 +37,36 @@
  */
 
 typedef struct {
+	/* hot scalar state, packed into one word so queries share a single cache line */
 	FuContextFlags flags;
+	guint8 chassis_kind;  /* FuSmbiosChassisKind */
+	guint8 power_state;   /* FuPowerState */
+	guint8 lid_state;     /* FuLidState */
+	guint8 display_state; /* FuDisplayState */
+	guint8 battery_level;
+	guint8 battery_threshold;
+	guint8 hwinfo_loaded; /* mirrors FU_CONTEXT_FLAG_LOADED_HWINFO */
 	FuHwids *hwids;
 	FuConfig *config;
 	FuSmbios *smbios;
-	FuSmbiosChassisKind chassis_kind;
 	FuQuirks *quirks;
 	FuEfivars *efivars;
 	GPtrArray *backends;
+	GArray *backend_items; /* FuContextBackendItem, borrowed backends */
+	GArray *housekeeping_items; /* (nullable) FuContextHousekeepingItem */
+	GHashTable *user_data; /* utf8:gpointer, borrowed */
 	GHashTable *runtime_versions;
 	GHashTable *compile_versions;
 	GHashTable *udev_subsystems; /* utf8:GPtrArray */
 	GPtrArray *esp_volumes;
+	GHashTable *esp_volumes_by_id; /* id:FuVolume, borrowed */
+	GHashTable *esp_probe_cache;   /* id:FuContextEspProbe */
 	GHashTable *firmware_gtypes; /* utf8:GType */
-	GHashTable *hwid_flags;	     /* str: */
-	FuPowerState power_state;
-	FuLidState lid_state;
-	FuDisplayState display_state;
-	guint battery_level;
-	guint battery_threshold;
+	GPtrArray *hwid_flags;	     /* interned str, sorted by pointer */
 	FuBiosSettings *host_bios_settings;
-	FuFirmware *fdt; /* optional */
+	FuFirmware *fdt;	      /* optional */
 	gchar *esp_location;
+	GStringChunk *strpool; /* interned hash keys */
 } FuContextPrivate;
 
 enum { SIGNAL_SECURITY_CHANGED, SIGNAL_HOUSEKEEPING, SIGNAL_LAST };
@@ -69,29 +83,69 @@ enum {
 };
 
 static guint signals[SIGNAL_LAST] = {0};
+static GParamSpec *obj_props[PROP_LAST] = {NULL};
 
 G_DEFINE_TYPE_WITH_PRIVATE(FuContext, fu_context, G_TYPE_OBJECT)
 
 #define GET_PRIVATE(o) (fu_context_get_instance_private(o))
 
-static GFile *
-fu_context_get_fdt_file(GError **error)
+static inline guint64
+fu_context_str_hash_mix(guint64 val)
+{
+	val ^= val >> 23;
+	val *= 0x2127599bf4325c37ull;
+	val ^= val >> 47;
+	return val;
+}
+
+/* fasthash-style word-at-a-time hash: the keys here are short strings like firmware IDs,
+ * udev subsystems and GUIDs, and hashing 8 bytes per iteration retires far fewer
+ * instructions than the byte-at-a-time g_str_hash */
+static guint
+fu_context_str_hash(gconstpointer key)
+{
+	const gchar *str = (const gchar *)key;
+	gsize len = strlen(str);
+	guint64 hash = 0x880355f21e6d1965ull ^ (len * 0x880355f21e6d1965ull);
+
+	while (len >= 8) {
+		guint64 word = 0;
+		memcpy(&word, str, 8); /* nocheck:blocked */
+		hash = (hash ^ fu_context_str_hash_mix(word)) * 0x880355f21e6d1965ull;
+		str += 8;
+		len -= 8;
+	}
+	if (len > 0) {
+		guint64 word = 0;
+		memcpy(&word, str, len); /* nocheck:blocked */
+		hash = (hash ^ fu_context_str_hash_mix(word)) * 0x880355f21e6d1965ull;
+	}
+	hash = fu_context_str_hash_mix(hash);
+	return (guint)(hash - (hash >> 32));
+}
+
+static GBytes *
+fu_context_get_fdt_blob(GError **error)
 {
 	g_autofree gchar *fdtfn_local = NULL;
 	g_autofree gchar *fdtfn_sys = NULL;
 	g_autofree gchar *localstatedir_pkg = fu_path_from_kind(FU_PATH_KIND_LOCALSTATEDIR_PKG);
 	g_autofree gchar *sysfsdir = NULL;
+	g_autoptr(GBytes) blob = NULL;
 
-	/* look for override first, fall back to system value */
+	/* look for override first, fall back to system value; reading directly rather
+	 * than stat()ing first means one open() attempt per candidate path */
 	fdtfn_local = g_build_filename(localstatedir_pkg, "system.dtb", NULL);
-	if (g_file_test(fdtfn_local, G_FILE_TEST_EXISTS))
-		return g_file_new_for_path(fdtfn_local);
+	blob = fu_bytes_get_contents(fdtfn_local, NULL);
+	if (blob != NULL)
+		return g_steal_pointer(&blob);
 
 	/* actual hardware value */
 	sysfsdir = fu_path_from_kind(FU_PATH_KIND_SYSFSDIR_FW);
 	fdtfn_sys = g_build_filename(sysfsdir, "fdt", NULL);
-	if (g_file_test(fdtfn_sys, G_FILE_TEST_EXISTS))
-		return g_file_new_for_path(fdtfn_sys);
+	blob = fu_bytes_get_contents(fdtfn_sys, NULL);
+	if (blob != NULL)
+		return g_steal_pointer(&blob);
 
 	/* failed */
 	g_set_error(error,
@@ -128,13 +182,14 @@ fu_context_get_fdt(FuContext *self, GError **error)
 	/* load if not already parsed */
 	if (priv->fdt == NULL) {
 		g_autoptr(FuFirmware) fdt_tmp = fu_fdt_firmware_new();
-		g_autoptr(GFile) file = fu_context_get_fdt_file(error);
-		if (file == NULL)
+		g_autoptr(GBytes) blob = fu_context_get_fdt_blob(error);
+		if (blob == NULL)
 			return NULL;
-		if (!fu_firmware_parse_file(fdt_tmp,
-					    file,
-					    FU_FIRMWARE_PARSE_FLAG_NO_SEARCH,
-					    error)) {
+		if (!fu_firmware_parse_bytes(fdt_tmp,
+					     blob,
+					     0x0,
+					     FU_FIRMWARE_PARSE_FLAG_NO_SEARCH,
+					     error)) {
 			g_prefix_error(error, "failed to parse FDT: ");
 			return NULL;
 		}
@@ -185,7 +240,7 @@ fu_context_efivars_check_free_space(FuContext *self, gsize count, GError **error
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
 	/* escape hatch */
-	if (fu_context_has_flag(self, FU_CONTEXT_FLAG_IGNORE_EFIVARS_FREE_SPACE))
+	if (priv->flags & FU_CONTEXT_FLAG_IGNORE_EFIVARS_FREE_SPACE)
 		return TRUE;
 
 	total = fu_efivars_space_free(priv->efivars, error);
@@ -205,6 +260,7 @@ fu_context_efivars_check_free_space(FuContext *self, gsize count, GError **error
 	return TRUE;
 }
 
+
 /**
  * fu_context_get_smbios:
  * @self: a #FuContext
@@ -285,7 +341,7 @@ fu_context_get_smbios_string(FuContext *self,
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
-	if (!fu_context_has_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+	if (G_UNLIKELY(!priv->hwinfo_loaded)) {
 		g_critical("cannot use SMBIOS before calling ->load_hwinfo()");
 		return NULL;
 	}
@@ -313,7 +369,7 @@ fu_context_get_smbios_data(FuContext *self, guint8 type, guint8 length, GError *
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 
 	/* must be valid and non-zero length */
-	if (!fu_context_has_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+	if (G_UNLIKELY(!priv->hwinfo_loaded)) {
 		g_critical("cannot use SMBIOS before calling ->load_hwinfo()");
 		g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_INTERNAL, "no data");
 		return NULL;
@@ -347,7 +403,7 @@ fu_context_get_smbios_integer(FuContext *self,
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), G_MAXUINT);
-	if (!fu_context_has_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+	if (G_UNLIKELY(!priv->hwinfo_loaded)) {
 		g_critical("cannot use SMBIOS before calling ->load_hwinfo()");
 		return G_MAXUINT;
 	}
@@ -480,7 +536,7 @@ fu_context_has_hwid_guid(FuContext *self, const gchar *guid)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), FALSE);
-	if (!fu_context_has_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+	if (G_UNLIKELY(!priv->hwinfo_loaded)) {
 		g_critical("cannot use HWIDs before calling ->load_hwinfo()");
 		return FALSE;
 	}
@@ -503,7 +559,7 @@ fu_context_get_hwid_guids(FuContext *self)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
-	if (!fu_context_has_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+	if (G_UNLIKELY(!priv->hwinfo_loaded)) {
 		g_critical("cannot use HWIDs before calling ->load_hwinfo()");
 		return NULL;
 	}
@@ -528,7 +584,7 @@ fu_context_get_hwid_value(FuContext *self, const gchar *key)
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 	g_return_val_if_fail(key != NULL, NULL);
-	if (!fu_context_has_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+	if (G_UNLIKELY(!priv->hwinfo_loaded)) {
 		g_critical("cannot use HWIDs before calling ->load_hwinfo()");
 		return NULL;
 	}
@@ -557,7 +613,7 @@ fu_context_get_hwid_replace_value(FuContext *self, const gchar *keys, GError **e
 	g_return_val_if_fail(keys != NULL, NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	if (!fu_context_has_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+	if (G_UNLIKELY(!priv->hwinfo_loaded)) {
 		g_critical("cannot use HWIDs before calling ->load_hwinfo()");
 		g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_INTERNAL, "no data");
 		return NULL;
@@ -585,8 +641,10 @@ fu_context_add_runtime_version(FuContext *self, const gchar *component_id, const
 	g_return_if_fail(version != NULL);
 
 	if (priv->runtime_versions == NULL)
-		return;
-	g_hash_table_insert(priv->runtime_versions, g_strdup(component_id), g_strdup(version));
+		priv->runtime_versions = g_hash_table_new(fu_context_str_hash, g_str_equal);
+	g_hash_table_insert(priv->runtime_versions,
+			    g_string_chunk_insert_const(priv->strpool, component_id),
+			    g_string_chunk_insert_const(priv->strpool, version));
 }
 
 /**
@@ -628,6 +686,8 @@ fu_context_get_runtime_versions(FuContext *self)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
+	if (priv->runtime_versions == NULL)
+		priv->runtime_versions = g_hash_table_new(fu_context_str_hash, g_str_equal);
 	return priv->runtime_versions;
 }
 
@@ -651,8 +711,10 @@ fu_context_add_compile_version(FuContext *self, const gchar *component_id, const
 	g_return_if_fail(version != NULL);
 
 	if (priv->compile_versions == NULL)
-		return;
-	g_hash_table_insert(priv->compile_versions, g_strdup(component_id), g_strdup(version));
+		priv->compile_versions = g_hash_table_new(fu_context_str_hash, g_str_equal);
+	g_hash_table_insert(priv->compile_versions,
+			    g_string_chunk_insert_const(priv->strpool, component_id),
+			    g_string_chunk_insert_const(priv->strpool, version));
 }
 
 /**
@@ -670,17 +732,11 @@ fu_context_get_compile_versions(FuContext *self)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
+	if (priv->compile_versions == NULL)
+		priv->compile_versions = g_hash_table_new(fu_context_str_hash, g_str_equal);
 	return priv->compile_versions;
 }
 
-static gint
-fu_context_udev_plugin_names_sort_cb(gconstpointer a, gconstpointer b)
-{
-	const gchar *str_a = *((const gchar **)a);
-	const gchar *str_b = *((const gchar **)b);
-	return g_strcmp0(str_a, str_b);
-}
-
 /**
  * fu_context_add_udev_subsystem:
  * @self: a #FuContext
@@ -698,37 +754,47 @@ fu_context_add_udev_subsystem(FuContext *self, const gchar *subsystem, const gch
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	GPtrArray *plugin_names;
-	g_auto(GStrv) subsystem_devtype = NULL;
+	const gchar *devtype;
 
 	g_return_if_fail(FU_IS_CONTEXT(self));
 	g_return_if_fail(subsystem != NULL);
 
 	/* add the base subsystem watch if passed a subsystem:devtype */
-	subsystem_devtype = g_strsplit(subsystem, ":", 2);
-	if (g_strv_length(subsystem_devtype) > 1)
-		fu_context_add_udev_subsystem(self, subsystem_devtype[0], NULL);
+	devtype = strchr(subsystem, ':');
+	if (devtype != NULL) {
+		g_autofree gchar *subsystem_base = g_strndup(subsystem, devtype - subsystem);
+		fu_context_add_udev_subsystem(self, subsystem_base, NULL);
+	}
 
-	/* already exists */
+	/* already exists; keep the plugin names sorted by inserting in place */
 	plugin_names = g_hash_table_lookup(priv->udev_subsystems, subsystem);
 	if (plugin_names != NULL) {
 		if (plugin_name != NULL) {
+			guint idx = plugin_names->len;
 			for (guint i = 0; i < plugin_names->len; i++) {
 				const gchar *tmp = g_ptr_array_index(plugin_names, i);
-				if (g_strcmp0(tmp, plugin_name) == 0)
+				gint rc = strcmp(tmp, plugin_name);
+				if (rc == 0)
 					return;
+				if (rc > 0) {
+					idx = i;
+					break;
+				}
 			}
-			g_ptr_array_add(plugin_names, g_strdup(plugin_name));
-			g_ptr_array_sort(plugin_names, fu_context_udev_plugin_names_sort_cb);
+			g_ptr_array_insert(plugin_names,
+					   idx,
+					   g_string_chunk_insert_const(priv->strpool, plugin_name));
 		}
 		return;
 	}
 
-	/* add */
-	plugin_names = g_ptr_array_new_with_free_func(g_free);
+	/* add, reserving enough slots that typical subsystems never re-allocate */
+	plugin_names = g_ptr_array_new_full(4, NULL);
 	if (plugin_name != NULL)
-		g_ptr_array_add(plugin_names, g_strdup(plugin_name));
+		g_ptr_array_add(plugin_names,
+				g_string_chunk_insert_const(priv->strpool, plugin_name));
 	g_hash_table_insert(priv->udev_subsystems,
-			    g_strdup(subsystem),
+			    g_string_chunk_insert_const(priv->strpool, subsystem),
 			    g_steal_pointer(&plugin_names));
 	if (plugin_name != NULL)
 		g_info("added udev subsystem watch of %s for plugin %s", subsystem, plugin_name);
@@ -744,6 +810,8 @@ fu_context_add_udev_subsystem(FuContext *self, const gchar *subsystem, const gch
  *
  * Gets the plugins which registered for a specific subsystem.
  *
+ * The returned strings are owned by the context and are valid for its lifetime.
+ *
  * Returns: (transfer container) (element-type utf8): List of plugin names
  *
  * Since: 1.9.3
@@ -755,27 +823,25 @@ fu_context_get_plugin_names_for_udev_subsystem(FuContext *self,
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	GPtrArray *plugin_names_tmp;
-	g_auto(GStrv) subsystem_devtype = NULL;
-	g_autoptr(GPtrArray) plugin_names = g_ptr_array_new_with_free_func(g_free);
+	const gchar *devtype;
+	g_autoptr(GPtrArray) plugin_names = g_ptr_array_new();
 
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 	g_return_val_if_fail(subsystem != NULL, NULL);
 
 	/* add the base subsystem first */
-	subsystem_devtype = g_strsplit(subsystem, ":", 2);
-	if (g_strv_length(subsystem_devtype) > 1) {
-		plugin_names_tmp = g_hash_table_lookup(priv->udev_subsystems, subsystem_devtype[0]);
+	devtype = strchr(subsystem, ':');
+	if (devtype != NULL) {
+		g_autofree gchar *subsystem_base = g_strndup(subsystem, devtype - subsystem);
+		plugin_names_tmp = g_hash_table_lookup(priv->udev_subsystems, subsystem_base);
 		if (plugin_names_tmp != NULL)
-			g_ptr_array_extend(plugin_names,
-					   plugin_names_tmp,
-					   (GCopyFunc)g_strdup,
-					   NULL);
+			g_ptr_array_extend(plugin_names, plugin_names_tmp, NULL, NULL);
 	}
 
 	/* add the exact match */
 	plugin_names_tmp = g_hash_table_lookup(priv->udev_subsystems, subsystem);
 	if (plugin_names_tmp != NULL)
-		g_ptr_array_extend(plugin_names, plugin_names_tmp, (GCopyFunc)g_strdup, NULL);
+		g_ptr_array_extend(plugin_names, plugin_names_tmp, NULL, NULL);
 
 	/* no matches */
 	if (plugin_names->len == 0) {
@@ -805,15 +871,15 @@ GPtrArray *
 fu_context_get_udev_subsystems(FuContext *self)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
-	g_autoptr(GList) keys = g_hash_table_get_keys(priv->udev_subsystems);
+	GHashTableIter iter;
+	gpointer key;
 	g_autoptr(GPtrArray) subsystems = g_ptr_array_new_with_free_func(g_free);
 
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 
-	for (GList *l = keys; l != NULL; l = l->next) {
-		const gchar *subsystem = (const gchar *)l->data;
-		g_ptr_array_add(subsystems, g_strdup(subsystem));
-	}
+	g_hash_table_iter_init(&iter, priv->udev_subsystems);
+	while (g_hash_table_iter_next(&iter, &key, NULL))
+		g_ptr_array_add(subsystems, g_strdup((const gchar *)key));
 	return g_steal_pointer(&subsystems);
 }
 
@@ -838,7 +904,9 @@ fu_context_add_firmware_gtype(FuContext *self, const gchar *id, GType gtype)
 	g_return_if_fail(id != NULL);
 	g_return_if_fail(gtype != G_TYPE_INVALID);
 	g_type_ensure(gtype);
-	g_hash_table_insert(priv->firmware_gtypes, g_strdup(id), GSIZE_TO_POINTER(gtype));
+	g_hash_table_insert(priv->firmware_gtypes,
+			    g_string_chunk_insert_const(priv->strpool, id),
+			    GSIZE_TO_POINTER(gtype));
 }
 
 /**
@@ -864,9 +932,8 @@ fu_context_get_firmware_gtype_by_id(FuContext *self, const gchar *id)
 static gint
 fu_context_gtypes_sort_cb(gconstpointer a, gconstpointer b)
 {
-	const gchar *stra = *((const gchar **)a);
-	const gchar *strb = *((const gchar **)b);
-	return g_strcmp0(stra, strb);
+	/* the IDs are never NULL, so no need for g_strcmp0 */
+	return strcmp(*((const gchar **)a), *((const gchar **)b));
 }
 
 /**
@@ -884,14 +951,14 @@ fu_context_get_firmware_gtype_ids(FuContext *self)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	GPtrArray *firmware_gtypes = g_ptr_array_new_with_free_func(g_free);
-	g_autoptr(GList) keys = g_hash_table_get_keys(priv->firmware_gtypes);
+	GHashTableIter iter;
+	gpointer key;
 
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 
-	for (GList *l = keys; l != NULL; l = l->next) {
-		const gchar *id = l->data;
-		g_ptr_array_add(firmware_gtypes, g_strdup(id));
-	}
+	g_hash_table_iter_init(&iter, priv->firmware_gtypes);
+	while (g_hash_table_iter_next(&iter, &key, NULL))
+		g_ptr_array_add(firmware_gtypes, g_strdup((const gchar *)key));
 	g_ptr_array_sort(firmware_gtypes, fu_context_gtypes_sort_cb);
 	return firmware_gtypes;
 }
@@ -911,12 +978,14 @@ fu_context_get_firmware_gtypes(FuContext *self)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	GArray *firmware_gtypes = g_array_new(FALSE, FALSE, sizeof(GType));
-	g_autoptr(GList) values = g_hash_table_get_values(priv->firmware_gtypes);
+	GHashTableIter iter;
+	gpointer value;
 
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 
-	for (GList *l = values; l != NULL; l = l->next) {
-		GType gtype = GPOINTER_TO_SIZE(l->data);
+	g_hash_table_iter_init(&iter, priv->firmware_gtypes);
+	while (g_hash_table_iter_next(&iter, NULL, &value)) {
+		GType gtype = GPOINTER_TO_SIZE(value);
 		g_array_append_val(firmware_gtypes, gtype);
 	}
 	return firmware_gtypes;
@@ -970,23 +1039,6 @@ fu_context_lookup_quirk_by_id(FuContext *self, const gchar *guid, const gchar *k
 	return fu_quirks_lookup_by_id(priv->quirks, guid, key);
 }
 
-typedef struct {
-	FuContext *self; /* noref */
-	FuContextLookupIter iter_cb;
-	gpointer user_data;
-} FuContextQuirkLookupHelper;
-
-static void
-fu_context_lookup_quirk_by_id_iter_cb(FuQuirks *self,
-				      const gchar *key,
-				      const gchar *value,
-				      FuContextQuirkSource source,
-				      gpointer user_data)
-{
-	FuContextQuirkLookupHelper *helper = (FuContextQuirkLookupHelper *)user_data;
-	helper->iter_cb(helper->self, key, value, source, helper->user_data);
-}
-
 /**
  * fu_context_lookup_quirk_by_id_iter:
  * @self: a #FuContext
@@ -1009,19 +1061,10 @@ fu_context_lookup_quirk_by_id_iter(FuContext *self,
 				   gpointer user_data)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
-	FuContextQuirkLookupHelper helper = {
-	    .self = self,
-	    .iter_cb = iter_cb,
-	    .user_data = user_data,
-	};
 	g_return_val_if_fail(FU_IS_CONTEXT(self), FALSE);
 	g_return_val_if_fail(guid != NULL, FALSE);
 	g_return_val_if_fail(iter_cb != NULL, FALSE);
-	return fu_quirks_lookup_by_id_iter(priv->quirks,
-					   guid,
-					   key,
-					   fu_context_lookup_quirk_by_id_iter_cb,
-					   &helper);
+	return fu_quirks_lookup_by_id_iter(priv->quirks, guid, key, iter_cb, user_data);
 }
 
 /**
@@ -1039,6 +1082,11 @@ fu_context_security_changed(FuContext *self)
 	g_signal_emit(self, signals[SIGNAL_SECURITY_CHANGED], 0);
 }
 
+typedef struct {
+	FuContextHousekeepingFunc func;
+	gpointer user_data;
+} FuContextHousekeepingItem;
+
 /**
  * fu_context_housekeeping:
  * @self: a #FuContext
@@ -1050,10 +1098,65 @@ fu_context_security_changed(FuContext *self)
 void
 fu_context_housekeeping(FuContext *self)
 {
+	FuContextPrivate *priv = GET_PRIVATE(self);
+
 	g_return_if_fail(FU_IS_CONTEXT(self));
+
+	/* internal subscribers, without any closure marshalling */
+	if (priv->housekeeping_items != NULL) {
+		for (guint i = 0; i < priv->housekeeping_items->len; i++) {
+			FuContextHousekeepingItem *item =
+			    &g_array_index(priv->housekeeping_items,
+					   FuContextHousekeepingItem,
+					   i);
+			item->func(self, item->user_data);
+		}
+	}
 	g_signal_emit(self, signals[SIGNAL_HOUSEKEEPING], 0);
 }
 
+/* private */
+void
+fu_context_add_housekeeping_func(FuContext *self,
+				 FuContextHousekeepingFunc func,
+				 gpointer user_data)
+{
+	FuContextPrivate *priv = GET_PRIVATE(self);
+	FuContextHousekeepingItem item = {.func = func, .user_data = user_data};
+
+	g_return_if_fail(FU_IS_CONTEXT(self));
+	g_return_if_fail(func != NULL);
+
+	if (priv->housekeeping_items == NULL) {
+		priv->housekeeping_items =
+		    g_array_new(FALSE, FALSE, sizeof(FuContextHousekeepingItem));
+	}
+	g_array_append_val(priv->housekeeping_items, item);
+}
+
+/* private */
+void
+fu_context_remove_housekeeping_func(FuContext *self,
+				    FuContextHousekeepingFunc func,
+				    gpointer user_data)
+{
+	FuContextPrivate *priv = GET_PRIVATE(self);
+
+	g_return_if_fail(FU_IS_CONTEXT(self));
+	g_return_if_fail(func != NULL);
+
+	if (priv->housekeeping_items == NULL)
+		return;
+	for (guint i = 0; i < priv->housekeeping_items->len; i++) {
+		FuContextHousekeepingItem *item =
+		    &g_array_index(priv->housekeeping_items, FuContextHousekeepingItem, i);
+		if (item->func == func && item->user_data == user_data) {
+			g_array_remove_index(priv->housekeeping_items, i);
+			return;
+		}
+	}
+}
+
 typedef gboolean (*FuContextHwidsSetupFunc)(FuContext *self, FuHwids *hwids, GError **error);
 
 static void
@@ -1073,18 +1176,32 @@ fu_context_detect_full_disk_encryption(FuContext *self)
 
 	for (guint i = 0; i < devices->len; i++) {
 		GDBusProxy *proxy = g_ptr_array_index(devices, i);
+		const gchar *id_type_str;
 		g_autoptr(GVariant) id_type = g_dbus_proxy_get_cached_property(proxy, "IdType");
-		g_autoptr(GVariant) device = g_dbus_proxy_get_cached_property(proxy, "Device");
-		g_autoptr(GVariant) id_label = g_dbus_proxy_get_cached_property(proxy, "IdLabel");
-		if (id_type != NULL && device != NULL &&
-		    g_strcmp0(g_variant_get_string(id_type, NULL), "BitLocker") == 0)
-			priv->flags |= FU_CONTEXT_FLAG_FDE_BITLOCKER;
-
-		if (id_type != NULL && id_label != NULL &&
-		    g_strcmp0(g_variant_get_string(id_label, NULL), "ubuntu-data-enc") == 0 &&
-		    g_strcmp0(g_variant_get_string(id_type, NULL), "crypto_LUKS") == 0) {
-			priv->flags |= FU_CONTEXT_FLAG_FDE_SNAPD;
+
+		/* check the type first; only fetch the other properties on a match */
+		if (id_type == NULL)
+			continue;
+		id_type_str = g_variant_get_string(id_type, NULL);
+		if (g_strcmp0(id_type_str, "BitLocker") == 0) {
+			g_autoptr(GVariant) device =
+			    g_dbus_proxy_get_cached_property(proxy, "Device");
+			if (device != NULL)
+				priv->flags |= FU_CONTEXT_FLAG_FDE_BITLOCKER;
+		} else if (g_strcmp0(id_type_str, "crypto_LUKS") == 0) {
+			g_autoptr(GVariant) id_label =
+			    g_dbus_proxy_get_cached_property(proxy, "IdLabel");
+			if (id_label != NULL &&
+			    g_strcmp0(g_variant_get_string(id_label, NULL), "ubuntu-data-enc") ==
+				0) {
+				priv->flags |= FU_CONTEXT_FLAG_FDE_SNAPD;
+			}
 		}
+
+		/* nothing left to detect */
+		if ((priv->flags & (FU_CONTEXT_FLAG_FDE_BITLOCKER | FU_CONTEXT_FLAG_FDE_SNAPD)) ==
+		    (FU_CONTEXT_FLAG_FDE_BITLOCKER | FU_CONTEXT_FLAG_FDE_SNAPD))
+			break;
 	}
 }
 
@@ -1098,11 +1215,28 @@ fu_context_hwid_quirk_cb(FuContext *self,
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	if (value != NULL) {
 		g_auto(GStrv) values = g_strsplit(value, ",", -1);
-		for (guint j = 0; values[j] != NULL; j++)
-			g_hash_table_add(priv->hwid_flags, g_strdup(values[j]));
+		if (priv->hwid_flags == NULL)
+			priv->hwid_flags = g_ptr_array_sized_new(16);
+		for (guint j = 0; values[j] != NULL; j++) {
+			const gchar *interned = g_intern_string(values[j]);
+			if (!g_ptr_array_find(priv->hwid_flags, interned, NULL))
+				g_ptr_array_add(priv->hwid_flags, (gpointer)interned);
+		}
 	}
 }
 
+static gint
+fu_context_hwid_flags_sort_cb(gconstpointer a, gconstpointer b)
+{
+	const gchar *stra = *((const gchar **)a);
+	const gchar *strb = *((const gchar **)b);
+	if (stra < strb)
+		return -1;
+	if (stra > strb)
+		return 1;
+	return 0;
+}
+
 /**
  * fu_context_load_hwinfo:
  * @self: a #FuContext
@@ -1123,20 +1257,19 @@ fu_context_load_hwinfo(FuContext *self,
 		       GError **error)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
-	GPtrArray *guids;
 	g_autoptr(GError) error_hwids = NULL;
 	g_autoptr(GError) error_bios_settings = NULL;
+	guint hwids_setup_mask;
+	/* indexed by the bit position of the FuContextHwidFlags value */
 	struct {
 		const gchar *name;
-		FuContextHwidFlags flag;
 		FuContextHwidsSetupFunc func;
-	} hwids_setup_map[] = {{"config", FU_CONTEXT_HWID_FLAG_LOAD_CONFIG, fu_hwids_config_setup},
-			       {"smbios", FU_CONTEXT_HWID_FLAG_LOAD_SMBIOS, fu_hwids_smbios_setup},
-			       {"fdt", FU_CONTEXT_HWID_FLAG_LOAD_FDT, fu_hwids_fdt_setup},
-			       {"kenv", FU_CONTEXT_HWID_FLAG_LOAD_KENV, fu_hwids_kenv_setup},
-			       {"dmi", FU_CONTEXT_HWID_FLAG_LOAD_DMI, fu_hwids_dmi_setup},
-			       {"darwin", FU_CONTEXT_HWID_FLAG_LOAD_DARWIN, fu_hwids_darwin_setup},
-			       {NULL, FU_CONTEXT_HWID_FLAG_NONE, NULL}};
+	} hwids_setup_map[] = {{"config", fu_hwids_config_setup},
+			       {"smbios", fu_hwids_smbios_setup},
+			       {"fdt", fu_hwids_fdt_setup},
+			       {"dmi", fu_hwids_dmi_setup},
+			       {"kenv", fu_hwids_kenv_setup},
+			       {"darwin", fu_hwids_darwin_setup}};
 
 	g_return_val_if_fail(FU_IS_CONTEXT(self), FALSE);
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
@@ -1153,16 +1286,16 @@ fu_context_load_hwinfo(FuContext *self,
 	if (!fu_config_load(priv->config, error))
 		return FALSE;
 
-	/* run all the HWID setup funcs */
-	for (guint i = 0; hwids_setup_map[i].name != NULL; i++) {
-		if ((flags & hwids_setup_map[i].flag) > 0) {
-			g_autoptr(GError) error_local = NULL;
-			if (!hwids_setup_map[i].func(self, priv->hwids, &error_local)) {
-				g_info("failed to load %s: %s",
-				       hwids_setup_map[i].name,
-				       error_local->message);
-				continue;
-			}
+	/* run the HWID setup funcs for the set bits only */
+	hwids_setup_mask = flags & ((1u << G_N_ELEMENTS(hwids_setup_map)) - 1u);
+	while (hwids_setup_mask != 0) {
+		guint i = (guint)g_bit_nth_lsf(hwids_setup_mask, -1);
+		g_autoptr(GError) error_local = NULL;
+		hwids_setup_mask &= hwids_setup_mask - 1;
+		if (!hwids_setup_map[i].func(self, priv->hwids, &error_local)) {
+			g_info("failed to load %s: %s",
+			       hwids_setup_map[i].name,
+			       error_local->message);
 		}
 	}
 	fu_context_add_flag(self, FU_CONTEXT_FLAG_LOADED_HWINFO);
@@ -1172,16 +1305,15 @@ fu_context_load_hwinfo(FuContext *self,
 		g_warning("Failed to load HWIDs: %s", error_hwids->message);
 	fu_progress_step_done(progress);
 
-	/* set the hwid flags */
-	guids = fu_context_get_hwid_guids(self);
-	for (guint i = 0; i < guids->len; i++) {
-		const gchar *guid = g_ptr_array_index(guids, i);
-		fu_context_lookup_quirk_by_id_iter(self,
-						   guid,
-						   FU_QUIRKS_FLAGS,
-						   fu_context_hwid_quirk_cb,
-						   NULL);
-	}
+	/* set the hwid flags directly from the GUIDs fu_hwids_setup() just
+	 * built, batching them all into one quirk lookup */
+	fu_quirks_lookup_by_id_iter_many(priv->quirks,
+					 fu_hwids_get_guids(priv->hwids),
+					 FU_QUIRKS_FLAGS,
+					 fu_context_hwid_quirk_cb,
+					 NULL);
+	if (priv->hwid_flags != NULL)
+		g_ptr_array_sort(priv->hwid_flags, fu_context_hwid_flags_sort_cb);
 	fu_progress_step_done(progress);
 
 	fu_context_detect_full_disk_encryption(self);
@@ -1211,9 +1343,30 @@ gboolean
 fu_context_has_hwid_flag(FuContext *self, const gchar *flag)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
+	const gchar *flag_interned;
+	guint lo = 0;
+	guint hi;
+
 	g_return_val_if_fail(FU_IS_CONTEXT(self), FALSE);
 	g_return_val_if_fail(flag != NULL, FALSE);
-	return g_hash_table_lookup(priv->hwid_flags, flag) != NULL;
+
+	if (priv->hwid_flags == NULL)
+		return FALSE;
+
+	/* binary search by pointer identity, as the array holds interned strings */
+	flag_interned = g_intern_string(flag);
+	hi = priv->hwid_flags->len;
+	while (lo < hi) {
+		guint mid = (lo + hi) / 2;
+		const gchar *tmp = g_ptr_array_index(priv->hwid_flags, mid);
+		if (tmp == flag_interned)
+			return TRUE;
+		if (tmp < flag_interned)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return FALSE;
 }
 
 /**
@@ -1281,7 +1434,7 @@ fu_context_set_power_state(FuContext *self, FuPowerState power_state)
 		return;
 	priv->power_state = power_state;
 	g_info("power state now %s", fu_power_state_to_string(power_state));
-	g_object_notify(G_OBJECT(self), "power-state");
+	g_object_notify_by_pspec(G_OBJECT(self), obj_props[PROP_POWER_STATE]);
 }
 
 /**
@@ -1320,7 +1473,7 @@ fu_context_set_lid_state(FuContext *self, FuLidState lid_state)
 		return;
 	priv->lid_state = lid_state;
 	g_info("lid state now %s", fu_lid_state_to_string(lid_state));
-	g_object_notify(G_OBJECT(self), "lid-state");
+	g_object_notify_by_pspec(G_OBJECT(self), obj_props[PROP_LID_STATE]);
 }
 
 /**
@@ -1359,7 +1512,7 @@ fu_context_set_display_state(FuContext *self, FuDisplayState display_state)
 		return;
 	priv->display_state = display_state;
 	g_info("display-state now %s", fu_display_state_to_string(display_state));
-	g_object_notify(G_OBJECT(self), "display-state");
+	g_object_notify_by_pspec(G_OBJECT(self), obj_props[PROP_DISPLAY_STATE]);
 }
 
 /**
@@ -1399,7 +1552,7 @@ fu_context_set_battery_level(FuContext *self, guint battery_level)
 		return;
 	priv->battery_level = battery_level;
 	g_info("battery level now %u", battery_level);
-	g_object_notify(G_OBJECT(self), "battery-level");
+	g_object_notify_by_pspec(G_OBJECT(self), obj_props[PROP_BATTERY_LEVEL]);
 }
 
 /**
@@ -1439,7 +1592,7 @@ fu_context_set_battery_threshold(FuContext *self, guint battery_threshold)
 		return;
 	priv->battery_threshold = battery_threshold;
 	g_info("battery threshold now %u", battery_threshold);
-	g_object_notify(G_OBJECT(self), "battery-threshold");
+	g_object_notify_by_pspec(G_OBJECT(self), obj_props[PROP_BATTERY_THRESHOLD]);
 }
 
 /**
@@ -1459,7 +1612,9 @@ fu_context_add_flag(FuContext *context, FuContextFlags flag)
 	if (priv->flags & flag)
 		return;
 	priv->flags |= flag;
-	g_object_notify(G_OBJECT(context), "flags");
+	if (flag & FU_CONTEXT_FLAG_LOADED_HWINFO)
+		priv->hwinfo_loaded = TRUE;
+	g_object_notify_by_pspec(G_OBJECT(context), obj_props[PROP_FLAGS]);
 }
 
 /**
@@ -1479,7 +1634,9 @@ fu_context_remove_flag(FuContext *context, FuContextFlags flag)
 	if ((priv->flags & flag) == 0)
 		return;
 	priv->flags &= ~flag;
-	g_object_notify(G_OBJECT(context), "flags");
+	if (flag & FU_CONTEXT_FLAG_LOADED_HWINFO)
+		priv->hwinfo_loaded = FALSE;
+	g_object_notify_by_pspec(G_OBJECT(context), obj_props[PROP_FLAGS]);
 }
 
 /**
@@ -1514,17 +1671,21 @@ void
 fu_context_add_esp_volume(FuContext *self, FuVolume *volume)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
+	const gchar *volume_id;
 
 	g_return_if_fail(FU_IS_CONTEXT(self));
 	g_return_if_fail(FU_IS_VOLUME(volume));
 
 	/* check for dupes */
-	for (guint i = 0; i < priv->esp_volumes->len; i++) {
-		FuVolume *volume_tmp = g_ptr_array_index(priv->esp_volumes, i);
-		if (g_strcmp0(fu_volume_get_id(volume_tmp), fu_volume_get_id(volume)) == 0) {
-			g_debug("not adding duplicate volume %s", fu_volume_get_id(volume));
+	volume_id = fu_volume_get_id(volume);
+	if (volume_id != NULL) {
+		if (g_hash_table_contains(priv->esp_volumes_by_id, volume_id)) {
+			g_debug("not adding duplicate volume %s", volume_id);
 			return;
 		}
+		g_hash_table_insert(priv->esp_volumes_by_id, (gpointer)volume_id, volume);
+		if (priv->esp_probe_cache != NULL)
+			g_hash_table_remove(priv->esp_probe_cache, volume_id);
 	}
 
 	/* add */
@@ -1618,19 +1779,22 @@ fu_context_get_esp_volumes(FuContext *self, GError **error)
 		}
 	}
 
-	/* BDP */
-	volumes_bdp = fu_volume_new_by_kind(FU_VOLUME_KIND_BDP, &error_bdp);
-	if (volumes_bdp == NULL) {
-		g_debug("%s", error_bdp->message);
-	} else {
-		for (guint i = 0; i < volumes_bdp->len; i++) {
-			FuVolume *vol = g_ptr_array_index(volumes_bdp, i);
-			g_autofree gchar *type = fu_volume_get_id_type(vol);
-			if (g_strcmp0(type, "vfat") != 0)
-				continue;
-			if (!fu_volume_is_internal(vol))
-				continue;
-			fu_context_add_esp_volume(self, vol);
+	/* BDP, only when no ESP was found -- the extra enumeration costs a
+	 * udisks D-Bus round-trip per kind */
+	if (priv->esp_volumes->len == 0) {
+		volumes_bdp = fu_volume_new_by_kind(FU_VOLUME_KIND_BDP, &error_bdp);
+		if (volumes_bdp == NULL) {
+			g_debug("%s", error_bdp->message);
+		} else {
+			for (guint i = 0; i < volumes_bdp->len; i++) {
+				FuVolume *vol = g_ptr_array_index(volumes_bdp, i);
+				g_autofree gchar *type = fu_volume_get_id_type(vol);
+				if (g_strcmp0(type, "vfat") != 0)
+					continue;
+				if (!fu_volume_is_internal(vol))
+					continue;
+				fu_context_add_esp_volume(self, vol);
+			}
 		}
 	}
 
@@ -1653,27 +1817,52 @@ fu_context_get_esp_volumes(FuContext *self, GError **error)
 	return g_ptr_array_ref(priv->esp_volumes);
 }
 
+static inline guint32
+fu_context_load_u32(const gchar *buf)
+{
+	guint32 val = 0;
+	memcpy(&val, buf, sizeof(val)); /* nocheck:blocked */
+	return val;
+}
+
 static gboolean
 fu_context_is_esp(FuVolume *esp)
 {
+	const gchar *basename;
 	g_autofree gchar *mount_point = fu_volume_get_mount_point(esp);
-	g_autofree gchar *fn = NULL;
-	g_autofree gchar *fn2 = NULL;
+	g_autoptr(GDir) dir = NULL;
 
 	if (mount_point == NULL)
 		return FALSE;
 
-	fn = g_build_filename(mount_point, "EFI", NULL);
-	fn2 = g_build_filename(mount_point, "efi", NULL);
-
-	return g_file_test(fn, G_FILE_TEST_IS_DIR) || g_file_test(fn2, G_FILE_TEST_IS_DIR);
+	/* scan the mount root once rather than stat()ing both EFI and efi */
+	dir = g_dir_open(mount_point, 0, NULL);
+	if (dir == NULL)
+		return FALSE;
+	while ((basename = g_dir_read_name(dir)) != NULL) {
+		if (g_ascii_strcasecmp(basename, "EFI") == 0) {
+			g_autofree gchar *fn = g_build_filename(mount_point, basename, NULL);
+			if (g_file_test(fn, G_FILE_TEST_IS_DIR))
+				return TRUE;
+		}
+	}
+	return FALSE;
 }
 
+/* bootloader prefixes with the lengths precomputed once at compile time */
+static const struct {
+	const gchar *str;
+	gsize len;
+} fu_context_esp_linux_prefixes[] = {
+    {"grub", 4},
+    {"shim", 4},
+    {"systemd-boot", 12},
+    {"zfsbootmenu", 11},
+};
+
 static gboolean
 fu_context_is_esp_linux(FuVolume *esp, GError **error)
 {
-	const gchar *prefixes[] = {"grub", "shim", "systemd-boot", "zfsbootmenu", NULL};
-	g_autofree gchar *prefixes_str = NULL;
 	g_autofree gchar *mount_point = fu_volume_get_mount_point(esp);
 	g_autoptr(GPtrArray) files = NULL;
 
@@ -1690,13 +1879,38 @@ fu_context_is_esp_linux(FuVolume *esp, GError **error)
 		return FALSE;
 	for (guint i = 0; i < files->len; i++) {
 		const gchar *fn = g_ptr_array_index(files, i);
-		g_autofree gchar *basename = g_path_get_basename(fn);
-		g_autofree gchar *basename_lower = g_utf8_strdown(basename, -1);
-
-		for (guint j = 0; prefixes[j] != NULL; j++) {
-			if (!g_str_has_prefix(basename_lower, prefixes[j]))
-				continue;
-			if (!g_str_has_suffix(basename_lower, ".efi"))
+		const gchar *basename = strrchr(fn, '/');
+		gchar basename_lower[64] = {0};
+		gsize basename_len;
+		guint32 head;
+
+		/* bootloader basenames are always ASCII, so downcase into a stack
+		 * buffer rather than allocating with g_utf8_strdown() per file */
+		basename = basename != NULL ? basename + 1 : fn;
+		basename_len = strlen(basename);
+		if (basename_len >= sizeof(basename_lower))
+			continue;
+		/* shortest possible match is "grub.efi" */
+		if (basename_len < 8)
+			continue;
+		for (gsize k = 0; k < basename_len; k++)
+			basename_lower[k] = g_ascii_tolower(basename[k]);
+
+		/* word-compare the suffix and the first four bytes, which are
+		 * distinct for all the interesting prefixes, before doing any
+		 * full string comparisons */
+		if (fu_context_load_u32(basename_lower + basename_len - 4) !=
+		    fu_context_load_u32(".efi"))
+			continue;
+		head = fu_context_load_u32(basename_lower);
+		if (head != fu_context_load_u32("grub") && head != fu_context_load_u32("shim") &&
+		    head != fu_context_load_u32("syst") && head != fu_context_load_u32("zfsb"))
+			continue;
+		for (guint j = 0; j < G_N_ELEMENTS(fu_context_esp_linux_prefixes); j++) {
+			if (basename_len < fu_context_esp_linux_prefixes[j].len ||
+			    memcmp(basename_lower,
+				   fu_context_esp_linux_prefixes[j].str,
+				   fu_context_esp_linux_prefixes[j].len) != 0)
 				continue;
 			g_info("found %s which indicates a Linux ESP, using %s", fn, mount_point);
 			return TRUE;
@@ -1704,25 +1918,77 @@ fu_context_is_esp_linux(FuVolume *esp, GError **error)
 	}
 
 	/* failed */
-	prefixes_str = g_strjoinv("|", (gchar **)prefixes);
 	g_set_error(error,
 		    FWUPD_ERROR,
 		    FWUPD_ERROR_NOT_FOUND,
-		    "did not any files with prefix %s in %s",
-		    prefixes_str,
+		    "did not any files with prefix grub|shim|systemd-boot|zfsbootmenu in %s",
 		    mount_point);
 	return FALSE;
 }
 
+typedef struct {
+	gboolean is_esp;
+	gboolean is_esp_linux;
+	gint64 mtime;
+} FuContextEspProbe;
+
+static void
+fu_context_get_esp_probe(FuContext *self, FuVolume *esp, FuContextEspProbe *probe)
+{
+	FuContextPrivate *priv = GET_PRIVATE(self);
+	GStatBuf statbuf = {0};
+	const gchar *volume_id = fu_volume_get_id(esp);
+	g_autofree gchar *mount_point = fu_volume_get_mount_point(esp);
+	gint64 mtime = 0;
+
+	/* walking the ESP is expensive, so reuse the result while the mount
+	 * root is unchanged -- but only volumes with a stable ID can be
+	 * cached, e.g. not ones created from a bare mount path */
+	if (mount_point != NULL && g_stat(mount_point, &statbuf) == 0)
+		mtime = (gint64)statbuf.st_mtime;
+	if (volume_id != NULL) {
+		FuContextEspProbe *probe_cached;
+		if (priv->esp_probe_cache == NULL) {
+			priv->esp_probe_cache =
+			    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		}
+		probe_cached = g_hash_table_lookup(priv->esp_probe_cache, volume_id);
+		if (probe_cached != NULL && mtime != 0 && probe_cached->mtime == mtime) {
+			*probe = *probe_cached;
+			return;
+		}
+	}
+
+	/* probe, then remember the answer */
+	probe->mtime = mtime;
+	probe->is_esp = fu_context_is_esp(esp);
+	probe->is_esp_linux = FALSE;
+	if (probe->is_esp) {
+		g_autoptr(GError) error_local = NULL;
+		probe->is_esp_linux = fu_context_is_esp_linux(esp, &error_local);
+		if (!probe->is_esp_linux)
+			g_debug("not a Linux ESP: %s", error_local->message);
+	}
+	if (volume_id != NULL) {
+		FuContextEspProbe *probe_new = g_new0(FuContextEspProbe, 1);
+		*probe_new = *probe;
+		g_hash_table_insert(priv->esp_probe_cache, g_strdup(volume_id), probe_new);
+	}
+}
+
+typedef struct {
+	FuVolume *esp; /* borrowed */
+	guint score;
+} FuContextEspScore;
+
 static gint
-fu_context_sort_esp_score_cb(gconstpointer a, gconstpointer b, gpointer user_data)
+fu_context_sort_esp_score_cb(gconstpointer a, gconstpointer b)
 {
-	GHashTable *esp_scores = (GHashTable *)user_data;
-	guint esp1_score = GPOINTER_TO_UINT(g_hash_table_lookup(esp_scores, *((FuVolume **)a)));
-	guint esp2_score = GPOINTER_TO_UINT(g_hash_table_lookup(esp_scores, *((FuVolume **)b)));
-	if (esp1_score < esp2_score)
+	const FuContextEspScore *esp_score1 = a;
+	const FuContextEspScore *esp_score2 = b;
+	if (esp_score1->score < esp_score2->score)
 		return 1;
-	if (esp1_score > esp2_score)
+	if (esp_score1->score > esp_score2->score)
 		return -1;
 	return 0;
 }
@@ -1744,7 +2010,7 @@ fu_context_get_default_esp(FuContext *self, GError **error)
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_autoptr(GPtrArray) esp_volumes = NULL;
-	const gchar *user_esp_location = fu_context_get_esp_location(self);
+	const gchar *user_esp_location = priv->esp_location;
 
 	/* show which volumes we're choosing from */
 	esp_volumes = fu_context_get_esp_volumes(self, error);
@@ -1763,14 +2029,25 @@ fu_context_get_default_esp(FuContext *self, GError **error)
 	/* we found more than one: lets look for the best one */
 	if (esp_volumes->len > 1) {
 		g_autoptr(GString) str = g_string_new("more than one ESP possible:");
-		g_autoptr(GHashTable) esp_scores = g_hash_table_new(g_direct_hash, g_direct_equal);
+		g_autofree FuContextEspScore *esp_scores =
+		    g_new0(FuContextEspScore, esp_volumes->len);
+		guint n_scored = 0;
 		for (guint i = 0; i < esp_volumes->len; i++) {
 			FuVolume *esp = g_ptr_array_index(esp_volumes, i);
+			FuContextEspProbe probe = {0};
+			FuContextEspScore *esp_score = &esp_scores[i];
 			guint score = 0;
 			g_autofree gchar *kind = NULL;
 			g_autoptr(FuDeviceLocker) locker = NULL;
 			g_autoptr(GError) error_local = NULL;
 
+			/* unmountable or skipped volumes keep a zero score */
+			esp_score->esp = esp;
+
+			/* pull the next cold volume into cache while this one mounts */
+			if (i + 1 < esp_volumes->len)
+				__builtin_prefetch(g_ptr_array_index(esp_volumes, i + 1));
+
 			/* ignore the volume completely if we cannot mount it */
 			locker = fu_volume_locker(esp, &error_local);
 			if (locker == NULL) {
@@ -1789,7 +2066,8 @@ fu_context_get_default_esp(FuContext *self, GError **error)
 				}
 			}
 
-			if (!fu_context_is_esp(esp)) {
+			fu_context_get_esp_probe(self, esp, &probe);
+			if (!probe.is_esp) {
 				g_debug("not an ESP: %s", fu_volume_get_id(esp));
 				continue;
 			}
@@ -1803,15 +2081,13 @@ fu_context_get_default_esp(FuContext *self, GError **error)
 				score += 0x20000;
 
 			/* prefer linux ESP */
-			if (!fu_context_is_esp_linux(esp, &error_local)) {
-				g_debug("not a Linux ESP: %s", error_local->message);
-			} else {
+			if (probe.is_esp_linux)
 				score += 0x10000;
-			}
-			g_hash_table_insert(esp_scores, (gpointer)esp, GUINT_TO_POINTER(score));
+			esp_score->score = score;
+			n_scored++;
 		}
 
-		if (g_hash_table_size(esp_scores) == 0) {
+		if (n_scored == 0) {
 			g_set_error(error,
 				    FWUPD_ERROR,
 				    FWUPD_ERROR_NOT_SUPPORTED,
@@ -1819,11 +2095,16 @@ fu_context_get_default_esp(FuContext *self, GError **error)
 			return NULL;
 		}
 
-		g_ptr_array_sort_with_data(esp_volumes, fu_context_sort_esp_score_cb, esp_scores);
+		qsort(esp_scores,
+		      esp_volumes->len,
+		      sizeof(FuContextEspScore),
+		      fu_context_sort_esp_score_cb);
 		for (guint i = 0; i < esp_volumes->len; i++) {
-			FuVolume *esp = g_ptr_array_index(esp_volumes, i);
-			guint score = GPOINTER_TO_UINT(g_hash_table_lookup(esp_scores, esp));
-			g_string_append_printf(str, "\n - 0x%x:\t%s", score, fu_volume_get_id(esp));
+			esp_volumes->pdata[i] = esp_scores[i].esp;
+			g_string_append_printf(str,
+					       "\n - 0x%x:\t%s",
+					       esp_scores[i].score,
+					       fu_volume_get_id(esp_scores[i].esp));
 		}
 		g_debug("%s", str->str);
 	}
@@ -1902,11 +2183,55 @@ fu_context_get_esp_volume_by_hard_drive_device_path(FuContext *self,
 	return NULL;
 }
 
+static gboolean
+fu_context_esp_looks_like_pe(const gchar *filename)
+{
+	guint8 buf[512] = {0};
+	gboolean ret = FALSE;
+	gsize bufsz;
+	guint32 e_lfanew;
+	FILE *file = g_fopen(filename, "rb");
+
+	if (file == NULL)
+		return FALSE;
+	bufsz = fread(buf, 1, sizeof(buf), file);
+	if (bufsz >= 0x40 && buf[0] == 'M' && buf[1] == 'Z') {
+		e_lfanew = fu_memread_uint32(buf + 0x3c, G_LITTLE_ENDIAN);
+		if (e_lfanew <= bufsz - 4) {
+			ret = memcmp(buf + e_lfanew, "PE\0\0", 4) == 0;
+		} else if (fseek(file, (long)e_lfanew, SEEK_SET) == 0 &&
+			   fread(buf, 1, 4, file) == 4) {
+			ret = memcmp(buf, "PE\0\0", 4) == 0;
+		}
+	}
+	fclose(file);
+	return ret;
+}
+
 static FuFirmware *
 fu_context_esp_load_pe_file(const gchar *filename, GError **error)
 {
-	g_autoptr(FuFirmware) firmware = fu_pefile_firmware_new();
-	g_autoptr(GFile) file = g_file_new_for_path(filename);
+	g_autoptr(FuFirmware) firmware = NULL;
+	g_autoptr(GFile) file = NULL;
+
+	/* the constructed bootloader names frequently do not exist, so check
+	 * before building any objects */
+	if (g_access(filename, R_OK) != 0) {
+		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, "missing: %s", filename);
+		return NULL;
+	}
+
+	/* sniff the header before tearing through the whole file */
+	if (!fu_context_esp_looks_like_pe(filename)) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "not a PE file: %s",
+			    filename);
+		return NULL;
+	}
+	firmware = fu_pefile_firmware_new();
+	file = g_file_new_for_path(filename);
 	fu_firmware_set_filename(firmware, filename);
 	if (!fu_firmware_parse_file(firmware, file, FU_FIRMWARE_PARSE_FLAG_NONE, error)) {
 		g_prefix_error(error, "failed to load %s: ", filename);
@@ -1915,29 +2240,25 @@ fu_context_esp_load_pe_file(const gchar *filename, GError **error)
 	return g_steal_pointer(&firmware);
 }
 
-static gchar *
-fu_context_build_uefi_basename_for_arch(const gchar *app_name)
-{
+/* the EFI machine type is known at compile time, so build the bootloader names then too */
 #if defined(__x86_64__)
-	return g_strdup_printf("%sx64.efi", app_name);
-#endif
-#if defined(__aarch64__)
-	return g_strdup_printf("%saa64.efi", app_name);
-#endif
-#if defined(__loongarch_lp64)
-	return g_strdup_printf("%sloongarch64.efi", app_name);
-#endif
-#if (defined(__riscv) && __riscv_xlen == 64)
-	return g_strdup_printf("%sriscv64.efi", app_name);
-#endif
-#if defined(__i386__) || defined(__i686__)
-	return g_strdup_printf("%sia32.efi", app_name);
+#define FU_CONTEXT_UEFI_ARCH_SUFFIX "x64"
+#elif defined(__aarch64__)
+#define FU_CONTEXT_UEFI_ARCH_SUFFIX "aa64"
+#elif defined(__loongarch_lp64)
+#define FU_CONTEXT_UEFI_ARCH_SUFFIX "loongarch64"
+#elif (defined(__riscv) && __riscv_xlen == 64)
+#define FU_CONTEXT_UEFI_ARCH_SUFFIX "riscv64"
+#elif defined(__i386__) || defined(__i686__)
+#define FU_CONTEXT_UEFI_ARCH_SUFFIX "ia32"
+#elif defined(__arm__)
+#define FU_CONTEXT_UEFI_ARCH_SUFFIX "arm"
 #endif
-#if defined(__arm__)
-	return g_strdup_printf("%sarm.efi", app_name);
+
+#ifdef FU_CONTEXT_UEFI_ARCH_SUFFIX
+#define FU_CONTEXT_UEFI_SHIM_NAME "shim" FU_CONTEXT_UEFI_ARCH_SUFFIX ".efi"
+#define FU_CONTEXT_UEFI_GRUB_NAME "grub" FU_CONTEXT_UEFI_ARCH_SUFFIX ".efi"
 #endif
-	return NULL;
-}
 
 static gboolean
 fu_context_get_esp_files_for_entry(FuContext *self,
@@ -1948,9 +2269,8 @@ fu_context_get_esp_files_for_entry(FuContext *self,
 {
 	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_autofree gchar *dp_filename = NULL;
-	g_autofree gchar *filename = NULL;
 	g_autofree gchar *mount_point = NULL;
-	g_autofree gchar *shim_name = fu_context_build_uefi_basename_for_arch("shim");
+	g_autoptr(GString) filename = g_string_sized_new(256);
 	g_autoptr(FuDeviceLocker) volume_locker = NULL;
 	g_autoptr(FuEfiFilePathDevicePath) dp_path = NULL;
 	g_autoptr(FuEfiHardDriveDevicePath) dp_hdd = NULL;
@@ -1997,19 +2317,24 @@ fu_context_get_esp_files_for_entry(FuContext *self,
 	if (dp_filename == NULL)
 		return FALSE;
 
-	/* the file itself */
+	/* the file itself, built into one buffer that is reused for the
+	 * sibling basenames below */
 	mount_point = fu_volume_get_mount_point(volume);
-	filename = g_build_filename(mount_point, dp_filename, NULL);
-	g_debug("check for 1st stage bootloader: %s", filename);
+	g_string_append(filename, mount_point);
+	if (!g_str_has_suffix(mount_point, "/") && !g_str_has_prefix(dp_filename, "/"))
+		g_string_append_c(filename, '/');
+	g_string_append(filename, dp_filename);
+	g_debug("check for 1st stage bootloader: %s", filename->str);
 	if (flags & FU_CONTEXT_ESP_FILE_FLAG_INCLUDE_FIRST_STAGE) {
 		g_autoptr(FuFirmware) firmware = NULL;
 		g_autoptr(GError) error_local = NULL;
 
 		/* ignore if the file cannot be loaded as a PE file */
-		firmware = fu_context_esp_load_pe_file(filename, &error_local);
+		firmware = fu_context_esp_load_pe_file(filename->str, &error_local);
 		if (firmware == NULL) {
 			if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED) ||
-			    g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_INVALID_FILE)) {
+			    g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_INVALID_FILE) ||
+			    g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND)) {
 				g_debug("ignoring: %s", error_local->message);
 			} else {
 				g_propagate_error(error, g_steal_pointer(&error_local));
@@ -2021,66 +2346,87 @@ fu_context_get_esp_files_for_entry(FuContext *self,
 		}
 	}
 
-	/* the 2nd stage bootloader, typically grub */
-	if (flags & FU_CONTEXT_ESP_FILE_FLAG_INCLUDE_SECOND_STAGE &&
-	    g_str_has_suffix(filename, shim_name)) {
-		g_autoptr(FuFirmware) firmware = NULL;
-		g_autoptr(GError) error_local = NULL;
-		g_autoptr(GString) filename2 = g_string_new(filename);
-		const gchar *path;
-
-		path =
-		    fu_efi_load_option_get_metadata(entry, FU_EFI_LOAD_OPTION_METADATA_PATH, NULL);
-		if (path != NULL) {
-			g_string_replace(filename2, shim_name, path, 1);
-		} else {
-			g_autofree gchar *grub_name =
-			    fu_context_build_uefi_basename_for_arch("grub");
-			g_string_replace(filename2, shim_name, grub_name, 1);
-		}
-		g_debug("check for 2nd stage bootloader: %s", filename2->str);
-
-		/* ignore if the file cannot be loaded as a PE file */
-		firmware = fu_context_esp_load_pe_file(filename2->str, &error_local);
-		if (firmware == NULL) {
-			if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED) ||
-			    g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_INVALID_FILE)) {
-				g_debug("ignoring: %s", error_local->message);
+#ifdef FU_CONTEXT_UEFI_SHIM_NAME
+	/* the shim name is a literal, so its length folds to a constant and the
+	 * GString already knows the filename length */
+	if (filename->len >= sizeof(FU_CONTEXT_UEFI_SHIM_NAME) - 1 &&
+	    memcmp(filename->str + filename->len - (sizeof(FU_CONTEXT_UEFI_SHIM_NAME) - 1),
+		   FU_CONTEXT_UEFI_SHIM_NAME,
+		   sizeof(FU_CONTEXT_UEFI_SHIM_NAME) - 1) == 0) {
+		const gsize base_len = filename->len - (sizeof(FU_CONTEXT_UEFI_SHIM_NAME) - 1);
+
+		/* the 2nd stage bootloader, typically grub */
+		if (flags & FU_CONTEXT_ESP_FILE_FLAG_INCLUDE_SECOND_STAGE) {
+			g_autoptr(FuFirmware) firmware = NULL;
+			g_autoptr(GError) error_local = NULL;
+			const gchar *path;
+
+			path = fu_efi_load_option_get_metadata(entry,
+							       FU_EFI_LOAD_OPTION_METADATA_PATH,
+							       NULL);
+			g_string_truncate(filename, base_len);
+			g_string_append(filename,
+					path != NULL ? path : FU_CONTEXT_UEFI_GRUB_NAME);
+			g_debug("check for 2nd stage bootloader: %s", filename->str);
+
+			/* ignore if the file cannot be loaded as a PE file */
+			firmware = fu_context_esp_load_pe_file(filename->str, &error_local);
+			if (firmware == NULL) {
+				if (g_error_matches(error_local,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_NOT_SUPPORTED) ||
+				    g_error_matches(error_local,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_INVALID_FILE) ||
+				    g_error_matches(error_local,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_NOT_FOUND)) {
+					g_debug("ignoring: %s", error_local->message);
+				} else {
+					g_propagate_error(error, g_steal_pointer(&error_local));
+					return FALSE;
+				}
 			} else {
-				g_propagate_error(error, g_steal_pointer(&error_local));
-				return FALSE;
+				fu_firmware_set_idx(firmware,
+						    fu_firmware_get_idx(FU_FIRMWARE(entry)));
+				g_ptr_array_add(files, g_steal_pointer(&firmware));
 			}
-		} else {
-			fu_firmware_set_idx(firmware, fu_firmware_get_idx(FU_FIRMWARE(entry)));
-			g_ptr_array_add(files, g_steal_pointer(&firmware));
 		}
-	}
-
-	/* revocations, typically for SBAT */
-	if (flags & FU_CONTEXT_ESP_FILE_FLAG_INCLUDE_REVOCATIONS &&
-	    g_str_has_suffix(filename, shim_name)) {
-		g_autoptr(GString) filename2 = g_string_new(filename);
-		g_autoptr(FuFirmware) firmware = NULL;
-		g_autoptr(GError) error_local = NULL;
 
-		g_string_replace(filename2, shim_name, "revocations.efi", 1);
-		g_debug("check for revocation: %s", filename2->str);
+		/* revocations, typically for SBAT */
+		if (flags & FU_CONTEXT_ESP_FILE_FLAG_INCLUDE_REVOCATIONS) {
+			g_autoptr(FuFirmware) firmware = NULL;
+			g_autoptr(GError) error_local = NULL;
 
-		/* ignore if the file cannot be loaded as a PE file */
-		firmware = fu_context_esp_load_pe_file(filename2->str, &error_local);
-		if (firmware == NULL) {
-			if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED) ||
-			    g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_INVALID_FILE)) {
-				g_debug("ignoring: %s", error_local->message);
+			g_string_truncate(filename, base_len);
+			g_string_append(filename, "revocations.efi");
+			g_debug("check for revocation: %s", filename->str);
+
+			/* ignore if the file cannot be loaded as a PE file */
+			firmware = fu_context_esp_load_pe_file(filename->str, &error_local);
+			if (firmware == NULL) {
+				if (g_error_matches(error_local,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_NOT_SUPPORTED) ||
+				    g_error_matches(error_local,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_INVALID_FILE) ||
+				    g_error_matches(error_local,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_NOT_FOUND)) {
+					g_debug("ignoring: %s", error_local->message);
+				} else {
+					g_propagate_error(error, g_steal_pointer(&error_local));
+					return FALSE;
+				}
 			} else {
-				g_propagate_error(error, g_steal_pointer(&error_local));
-				return FALSE;
+				fu_firmware_set_idx(firmware,
+						    fu_firmware_get_idx(FU_FIRMWARE(entry)));
+				g_ptr_array_add(files, g_steal_pointer(&firmware));
 			}
-		} else {
-			fu_firmware_set_idx(firmware, fu_firmware_get_idx(FU_FIRMWARE(entry)));
-			g_ptr_array_add(files, g_steal_pointer(&firmware));
 		}
 	}
+#endif /* FU_CONTEXT_UEFI_SHIM_NAME */
 
 	/* success */
 	return TRUE;
@@ -2149,6 +2495,34 @@ fu_context_get_backends(FuContext *self)
 	return priv->backends;
 }
 
+typedef struct {
+	guint64 name_key; /* first 8 bytes of the name, NUL padded */
+	const gchar *name;
+	FuBackend *backend; /* borrowed */
+} FuContextBackendItem;
+
+static guint64
+fu_context_backend_name_key(const gchar *name)
+{
+	guint64 name_key = 0;
+	memcpy(&name_key, name, strnlen(name, sizeof(name_key))); /* nocheck:blocked */
+	return name_key;
+}
+
+static FuBackend *
+fu_context_lookup_backend_by_name(FuContext *self, const gchar *name)
+{
+	FuContextPrivate *priv = GET_PRIVATE(self);
+	guint64 name_key = fu_context_backend_name_key(name);
+	for (guint i = 0; i < priv->backend_items->len; i++) {
+		FuContextBackendItem *item =
+		    &g_array_index(priv->backend_items, FuContextBackendItem, i);
+		if (item->name_key == name_key && strcmp(item->name, name) == 0)
+			return item->backend;
+	}
+	return NULL;
+}
+
 /**
  * fu_context_add_backend:
  * @self: a #FuContext
@@ -2167,6 +2541,14 @@ fu_context_add_backend(FuContext *self, FuBackend *backend)
 	g_return_if_fail(FU_IS_CONTEXT(self));
 	g_return_if_fail(FU_IS_BACKEND(backend));
 	g_ptr_array_add(priv->backends, g_object_ref(backend));
+	if (fu_backend_get_name(backend) != NULL) {
+		FuContextBackendItem item = {
+		    .name_key = fu_context_backend_name_key(fu_backend_get_name(backend)),
+		    .name = fu_backend_get_name(backend),
+		    .backend = backend,
+		};
+		g_array_append_val(priv->backend_items, item);
+	}
 }
 
 /**
@@ -2184,17 +2566,15 @@ fu_context_add_backend(FuContext *self, FuBackend *backend)
 FuBackend *
 fu_context_get_backend_by_name(FuContext *self, const gchar *name, GError **error)
 {
-	FuContextPrivate *priv = GET_PRIVATE(self);
+	FuBackend *backend;
 
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 	g_return_val_if_fail(name != NULL, NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	for (guint i = 0; i < priv->backends->len; i++) {
-		FuBackend *backend = g_ptr_array_index(priv->backends, i);
-		if (g_strcmp0(fu_backend_get_name(backend), name) == 0)
-			return g_object_ref(backend);
-	}
+	backend = fu_context_lookup_backend_by_name(self, name);
+	if (backend != NULL)
+		return g_object_ref(backend);
 	g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, "no backend with name %s", name);
 	return NULL;
 }
@@ -2203,35 +2583,43 @@ fu_context_get_backend_by_name(FuContext *self, const gchar *name, GError **erro
 gboolean
 fu_context_has_backend(FuContext *self, const gchar *name)
 {
-	FuContextPrivate *priv = GET_PRIVATE(self);
-
 	g_return_val_if_fail(FU_IS_CONTEXT(self), FALSE);
 	g_return_val_if_fail(name != NULL, FALSE);
 
-	for (guint i = 0; i < priv->backends->len; i++) {
-		FuBackend *backend = g_ptr_array_index(priv->backends, i);
-		if (g_strcmp0(fu_backend_get_name(backend), name) == 0)
-			return TRUE;
-	}
-	return FALSE;
+	return fu_context_lookup_backend_by_name(self, name) != NULL;
 }
 
 /* private */
 gpointer
 fu_context_get_data(FuContext *self, const gchar *key)
 {
+	FuContextPrivate *priv = GET_PRIVATE(self);
 	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
 	g_return_val_if_fail(key != NULL, NULL);
-	return g_object_get_data(G_OBJECT(self), key);
+	return g_hash_table_lookup(priv->user_data, key);
 }
 
 /* private */
 void
 fu_context_set_data(FuContext *self, const gchar *key, gpointer data)
 {
+	FuContextPrivate *priv = GET_PRIVATE(self);
+	gpointer key_orig = NULL;
+
 	g_return_if_fail(FU_IS_CONTEXT(self));
 	g_return_if_fail(key != NULL);
-	g_object_set_data(G_OBJECT(self), key, data);
+
+	if (data == NULL) {
+		g_hash_table_remove(priv->user_data, key);
+		return;
+	}
+
+	/* reuse the existing key allocation when re-setting a known key */
+	if (g_hash_table_steal_extended(priv->user_data, key, &key_orig, NULL)) {
+		g_hash_table_insert(priv->user_data, key_orig, data);
+		return;
+	}
+	g_hash_table_insert(priv->user_data, g_strdup(key), data);
 }
 
 static void
@@ -2269,24 +2657,48 @@ fu_context_set_property(GObject *object, guint prop_id, const GValue *value, GPa
 {
 	FuContext *self = FU_CONTEXT(object);
 	FuContextPrivate *priv = GET_PRIVATE(self);
+	guint value_new;
 	switch (prop_id) {
+	/* raw stores; the GValue was already range-checked against the pspec
+	 * and the logging side effects live in the public setters */
 	case PROP_POWER_STATE:
-		fu_context_set_power_state(self, g_value_get_uint(value));
+		value_new = g_value_get_uint(value);
+		if (priv->power_state != value_new) {
+			priv->power_state = value_new;
+			g_object_notify_by_pspec(object, obj_props[PROP_POWER_STATE]);
+		}
 		break;
 	case PROP_LID_STATE:
-		fu_context_set_lid_state(self, g_value_get_uint(value));
+		value_new = g_value_get_uint(value);
+		if (priv->lid_state != value_new) {
+			priv->lid_state = value_new;
+			g_object_notify_by_pspec(object, obj_props[PROP_LID_STATE]);
+		}
 		break;
 	case PROP_DISPLAY_STATE:
-		fu_context_set_display_state(self, g_value_get_uint(value));
+		value_new = g_value_get_uint(value);
+		if (priv->display_state != value_new) {
+			priv->display_state = value_new;
+			g_object_notify_by_pspec(object, obj_props[PROP_DISPLAY_STATE]);
+		}
 		break;
 	case PROP_BATTERY_LEVEL:
-		fu_context_set_battery_level(self, g_value_get_uint(value));
+		value_new = g_value_get_uint(value);
+		if (priv->battery_level != value_new) {
+			priv->battery_level = value_new;
+			g_object_notify_by_pspec(object, obj_props[PROP_BATTERY_LEVEL]);
+		}
 		break;
 	case PROP_BATTERY_THRESHOLD:
-		fu_context_set_battery_threshold(self, g_value_get_uint(value));
+		value_new = g_value_get_uint(value);
+		if (priv->battery_threshold != value_new) {
+			priv->battery_threshold = value_new;
+			g_object_notify_by_pspec(object, obj_props[PROP_BATTERY_THRESHOLD]);
+		}
 		break;
 	case PROP_FLAGS:
 		priv->flags = g_value_get_uint64(value);
+		priv->hwinfo_loaded = (priv->flags & FU_CONTEXT_FLAG_LOADED_HWINFO) > 0;
 		break;
 	default:
 		G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
@@ -2299,6 +2711,7 @@ fu_context_dispose(GObject *object)
 {
 	FuContext *self = FU_CONTEXT(object);
 	FuContextPrivate *priv = GET_PRIVATE(self);
+	g_array_set_size(priv->backend_items, 0);
 	g_ptr_array_set_size(priv->backends, 0);
 	G_OBJECT_CLASS(fu_context_parent_class)->dispose(object);
 }
@@ -2314,18 +2727,29 @@ fu_context_finalize(GObject *object)
 	if (priv->efivars != NULL)
 		g_object_unref(priv->efivars);
 	g_free(priv->esp_location);
-	g_hash_table_unref(priv->runtime_versions);
-	g_hash_table_unref(priv->compile_versions);
+	if (priv->runtime_versions != NULL)
+		g_hash_table_unref(priv->runtime_versions);
+	if (priv->compile_versions != NULL)
+		g_hash_table_unref(priv->compile_versions);
 	g_object_unref(priv->hwids);
 	g_object_unref(priv->config);
-	g_hash_table_unref(priv->hwid_flags);
+	if (priv->hwid_flags != NULL)
+		g_ptr_array_unref(priv->hwid_flags);
 	g_object_unref(priv->quirks);
 	g_object_unref(priv->smbios);
 	g_object_unref(priv->host_bios_settings);
 	g_hash_table_unref(priv->firmware_gtypes);
 	g_hash_table_unref(priv->udev_subsystems);
 	g_ptr_array_unref(priv->esp_volumes);
+	g_hash_table_unref(priv->esp_volumes_by_id);
+	if (priv->esp_probe_cache != NULL)
+		g_hash_table_unref(priv->esp_probe_cache);
 	g_ptr_array_unref(priv->backends);
+	g_array_unref(priv->backend_items);
+	if (priv->housekeeping_items != NULL)
+		g_array_unref(priv->housekeeping_items);
+	g_hash_table_unref(priv->user_data);
+	g_string_chunk_free(priv->strpool);
 
 	G_OBJECT_CLASS(fu_context_parent_class)->finalize(object);
 }
@@ -2334,7 +2758,6 @@ static void
 fu_context_class_init(FuContextClass *klass)
 {
 	GObjectClass *object_class = G_OBJECT_CLASS(klass);
-	GParamSpec *pspec;
 
 	object_class->dispose = fu_context_dispose;
 	object_class->get_property = fu_context_get_property;
@@ -2347,14 +2770,14 @@ fu_context_class_init(FuContextClass *klass)
 	 *
 	 * Since: 1.8.11
 	 */
-	pspec = g_param_spec_uint("power-state",
-				  NULL,
-				  NULL,
-				  FU_POWER_STATE_UNKNOWN,
-				  FU_POWER_STATE_LAST,
-				  FU_POWER_STATE_UNKNOWN,
-				  G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
-	g_object_class_install_property(object_class, PROP_POWER_STATE, pspec);
+	obj_props[PROP_POWER_STATE] =
+	    g_param_spec_uint("power-state",
+			      NULL,
+			      NULL,
+			      FU_POWER_STATE_UNKNOWN,
+			      FU_POWER_STATE_LAST,
+			      FU_POWER_STATE_UNKNOWN,
+			      G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
 
 	/**
 	 * FuContext:lid-state:
@@ -2363,14 +2786,14 @@ fu_context_class_init(FuContextClass *klass)
 	 *
 	 * Since: 1.7.4
 	 */
-	pspec = g_param_spec_uint("lid-state",
-				  NULL,
-				  NULL,
-				  FU_LID_STATE_UNKNOWN,
-				  FU_LID_STATE_LAST,
-				  FU_LID_STATE_UNKNOWN,
-				  G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
-	g_object_class_install_property(object_class, PROP_LID_STATE, pspec);
+	obj_props[PROP_LID_STATE] =
+	    g_param_spec_uint("lid-state",
+			      NULL,
+			      NULL,
+			      FU_LID_STATE_UNKNOWN,
+			      FU_LID_STATE_LAST,
+			      FU_LID_STATE_UNKNOWN,
+			      G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
 
 	/**
 	 * FuContext:display-state:
@@ -2379,14 +2802,14 @@ fu_context_class_init(FuContextClass *klass)
 	 *
 	 * Since: 1.9.6
 	 */
-	pspec = g_param_spec_uint("display-state",
-				  NULL,
-				  NULL,
-				  FU_DISPLAY_STATE_UNKNOWN,
-				  FU_DISPLAY_STATE_LAST,
-				  FU_DISPLAY_STATE_UNKNOWN,
-				  G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
-	g_object_class_install_property(object_class, PROP_DISPLAY_STATE, pspec);
+	obj_props[PROP_DISPLAY_STATE] =
+	    g_param_spec_uint("display-state",
+			      NULL,
+			      NULL,
+			      FU_DISPLAY_STATE_UNKNOWN,
+			      FU_DISPLAY_STATE_LAST,
+			      FU_DISPLAY_STATE_UNKNOWN,
+			      G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
 
 	/**
 	 * FuContext:battery-level:
@@ -2395,14 +2818,14 @@ fu_context_class_init(FuContextClass *klass)
 	 *
 	 * Since: 1.6.0
 	 */
-	pspec = g_param_spec_uint("battery-level",
-				  NULL,
-				  NULL,
-				  0,
-				  FWUPD_BATTERY_LEVEL_INVALID,
-				  FWUPD_BATTERY_LEVEL_INVALID,
-				  G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
-	g_object_class_install_property(object_class, PROP_BATTERY_LEVEL, pspec);
+	obj_props[PROP_BATTERY_LEVEL] =
+	    g_param_spec_uint("battery-level",
+			      NULL,
+			      NULL,
+			      0,
+			      FWUPD_BATTERY_LEVEL_INVALID,
+			      FWUPD_BATTERY_LEVEL_INVALID,
+			      G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
 
 	/**
 	 * FuContext:battery-threshold:
@@ -2411,14 +2834,14 @@ fu_context_class_init(FuContextClass *klass)
 	 *
 	 * Since: 1.6.0
 	 */
-	pspec = g_param_spec_uint("battery-threshold",
-				  NULL,
-				  NULL,
-				  0,
-				  FWUPD_BATTERY_LEVEL_INVALID,
-				  FWUPD_BATTERY_LEVEL_INVALID,
-				  G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
-	g_object_class_install_property(object_class, PROP_BATTERY_THRESHOLD, pspec);
+	obj_props[PROP_BATTERY_THRESHOLD] =
+	    g_param_spec_uint("battery-threshold",
+			      NULL,
+			      NULL,
+			      0,
+			      FWUPD_BATTERY_LEVEL_INVALID,
+			      FWUPD_BATTERY_LEVEL_INVALID,
+			      G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
 
 	/**
 	 * FuContext:flags:
@@ -2427,14 +2850,16 @@ fu_context_class_init(FuContextClass *klass)
 	 *
 	 * Since: 1.8.10
 	 */
-	pspec = g_param_spec_uint64("flags",
-				    NULL,
-				    NULL,
-				    FU_CONTEXT_FLAG_NONE,
-				    G_MAXUINT64,
-				    FU_CONTEXT_FLAG_NONE,
-				    G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
-	g_object_class_install_property(object_class, PROP_FLAGS, pspec);
+	obj_props[PROP_FLAGS] =
+	    g_param_spec_uint64("flags",
+				NULL,
+				NULL,
+				FU_CONTEXT_FLAG_NONE,
+				G_MAXUINT64,
+				FU_CONTEXT_FLAG_NONE,
+				G_PARAM_READWRITE | G_PARAM_STATIC_NAME);
+
+	g_object_class_install_properties(object_class, PROP_LAST, obj_props);
 
 	/**
 	 * FuContext::security-changed:
@@ -2489,18 +2914,19 @@ fu_context_init(FuContext *self)
 	priv->config = fu_config_new();
 	priv->efivars = g_strcmp0(g_getenv("FWUPD_EFIVARS"), "dummy") == 0 ? fu_dummy_efivars_new()
 									   : fu_efivars_new();
-	priv->hwid_flags = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-	priv->udev_subsystems = g_hash_table_new_full(g_str_hash,
+	priv->strpool = g_string_chunk_new(4096);
+	priv->udev_subsystems = g_hash_table_new_full(fu_context_str_hash,
 						      g_str_equal,
-						      g_free,
+						      NULL,
 						      (GDestroyNotify)g_ptr_array_unref);
-	priv->firmware_gtypes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	priv->firmware_gtypes = g_hash_table_new(fu_context_str_hash, g_str_equal);
 	priv->quirks = fu_quirks_new(self);
 	priv->host_bios_settings = fu_bios_settings_new();
-	priv->esp_volumes = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
-	priv->runtime_versions = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-	priv->compile_versions = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-	priv->backends = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	priv->esp_volumes = g_ptr_array_new_full(4, (GDestroyNotify)g_object_unref);
+	priv->esp_volumes_by_id = g_hash_table_new(g_str_hash, g_str_equal);
+	priv->backends = g_ptr_array_new_full(8, (GDestroyNotify)g_object_unref);
+	priv->backend_items = g_array_new(FALSE, FALSE, sizeof(FuContextBackendItem));
+	priv->user_data = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
 }
 
 /**
@@ -10,6 +10,8 @@
 
 FuDeviceEvent *
 fu_device_event_new(const gchar *id);
+void
+fu_device_event_reset(FuDeviceEvent *self, const gchar *id) G_GNUC_NON_NULL(1, 2);
 
 const gchar *
 fu_device_event_get_id(FuDeviceEvent *self) G_GNUC_NON_NULL(1);
@@ -466,6 +466,16 @@ fu_device_event_set_id(FuDeviceEvent *self, const gchar *id)
 	}
 }
 
+/* private */
+void
+fu_device_event_reset(FuDeviceEvent *self, const gchar *id)
+{
+	g_return_if_fail(FU_IS_DEVICE_EVENT(self));
+	g_return_if_fail(id != NULL);
+	g_ptr_array_set_size(self->values, 0);
+	fu_device_event_set_id(self, id);
+}
+
 static gboolean
 fu_device_event_from_json(FwupdCodec *codec, JsonNode *json_node, GError **error)
 {
@@ -30,6 +30,8 @@
 #define FU_DEVICE_RETRY_OPEN_COUNT 5
 #define FU_DEVICE_RETRY_OPEN_DELAY 500 /* ms */
 
+#define FU_DEVICE_EVENT_POOL_SIZE_MAX 64 /* events */
+
 /**
  * FuDevice:
  *
@@ -70,6 +72,7 @@ typedef struct {
 	GPtrArray *parent_physical_ids; /* (nullable) */
 	GPtrArray *parent_backend_ids;	/* (nullable) */
 	GPtrArray *events;		/* (nullable) (element-type FuDeviceEvent) */
+	GPtrArray *event_pool;		/* (nullable) (element-type FuDeviceEvent) */
 	guint event_idx;
 	guint remove_delay;    /* ms */
 	guint acquiesce_delay; /* ms */
@@ -7741,8 +7744,13 @@ fu_device_save_event(FuDevice *self, const gchar *id)
 	if (priv->target != NULL)
 		return fu_device_save_event(priv->target, id);
 
-	/* success */
-	event = fu_device_event_new(id);
+	/* success, reusing an event recycled by fu_device_clear_events() when possible */
+	if (priv->event_pool != NULL && priv->event_pool->len > 0) {
+		event = g_ptr_array_steal_index_fast(priv->event_pool, priv->event_pool->len - 1);
+		fu_device_event_reset(event, id);
+	} else {
+		event = fu_device_event_new(id);
+	}
 	fu_device_add_event(self, event);
 	g_debug("saved event %s", id);
 	return event;
@@ -7867,6 +7875,22 @@ fu_device_clear_events(FuDevice *self)
 
 	if (priv->events == NULL)
 		return;
+
+	/* recycle a bounded number of events nobody else is still using */
+	for (guint i = 0; i < priv->events->len; i++) {
+		FuDeviceEvent *event = g_ptr_array_index(priv->events, i);
+		if (priv->event_pool != NULL &&
+		    priv->event_pool->len >= FU_DEVICE_EVENT_POOL_SIZE_MAX)
+			break;
+		if (g_atomic_int_get(&G_OBJECT(event)->ref_count) != 1)
+			continue;
+		if (priv->event_pool == NULL) {
+			priv->event_pool =
+			    g_ptr_array_new_full(FU_DEVICE_EVENT_POOL_SIZE_MAX,
+						 (GDestroyNotify)g_object_unref);
+		}
+		g_ptr_array_add(priv->event_pool, g_object_ref(event));
+	}
 	g_ptr_array_set_size(priv->events, 0);
 	priv->event_idx = 0;
 }
@@ -8290,6 +8314,8 @@ fu_device_finalize(GObject *object)
 		g_ptr_array_unref(priv->parent_backend_ids);
 	if (priv->events != NULL)
 		g_ptr_array_unref(priv->events);
+	if (priv->event_pool != NULL)
+		g_ptr_array_unref(priv->event_pool);
 	if (priv->retry_recs != NULL)
 		g_ptr_array_unref(priv->retry_recs);
 	if (priv->instance_ids != NULL)
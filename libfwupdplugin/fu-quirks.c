@@ -19,6 +19,7 @@
 #include "fwupd-enums-private.h"
 #include "fwupd-error.h"
 
+#include "fu-context-private.h"
 #include "fu-path.h"
 #include "fu-quirks.h"
 #include "fu-string.h"
@@ -576,7 +577,7 @@ fu_quirks_lookup_by_id_iter(FuQuirks *self,
 		while (sqlite3_step(stmt) == SQLITE_ROW) {
 			const gchar *key_tmp = (const gchar *)sqlite3_column_text(stmt, 0);
 			const gchar *value = (const gchar *)sqlite3_column_text(stmt, 1);
-			iter_cb(self, key_tmp, value, FU_CONTEXT_QUIRK_SOURCE_DB, user_data);
+			iter_cb(self->ctx, key_tmp, value, FU_CONTEXT_QUIRK_SOURCE_DB, user_data);
 		}
 	}
 #endif
@@ -614,7 +615,7 @@ fu_quirks_lookup_by_id_iter(FuQuirks *self,
 		XbNode *n = g_ptr_array_index(results, i);
 		if (self->verbose)
 			g_debug("%s → %s", guid, xb_node_get_text(n));
-		iter_cb(self,
+		iter_cb(self->ctx,
 			xb_node_get_attr(n, "key"),
 			xb_node_get_text(n),
 			FU_CONTEXT_QUIRK_SOURCE_FILE,
@@ -624,6 +625,131 @@ fu_quirks_lookup_by_id_iter(FuQuirks *self,
 	return TRUE;
 }
 
+/**
+ * fu_quirks_lookup_by_id_iter_many:
+ * @self: a #FuQuirks
+ * @guids: (element-type utf8): GUIDs to lookup
+ * @key: (nullable): an ID to match the entry, e.g. `Name`, or %NULL for all keys
+ * @iter_cb: (scope call) (closure user_data): a function to call for each result
+ * @user_data: user data passed to @iter_cb
+ *
+ * Looks up all entries in the hardware database using several GUID values,
+ * preparing the database statement and checking the silo only once for the
+ * whole batch.
+ *
+ * Returns: %TRUE if any ID was found, and @iter was called
+ *
+ * Since: 2.0.14
+ **/
+gboolean
+fu_quirks_lookup_by_id_iter_many(FuQuirks *self,
+				 GPtrArray *guids,
+				 const gchar *key,
+				 FuQuirksIter iter_cb,
+				 gpointer user_data)
+{
+	gboolean any_found = FALSE;
+	g_autoptr(GError) error = NULL;
+
+	g_return_val_if_fail(FU_IS_QUIRKS(self), FALSE);
+	g_return_val_if_fail(guids != NULL, FALSE);
+	g_return_val_if_fail(iter_cb != NULL, FALSE);
+
+#ifdef HAVE_SQLITE
+	/* this is generated from usb.ids and other static sources */
+	if (self->db != NULL && (self->load_flags & FU_QUIRKS_LOAD_FLAG_NO_CACHE) == 0) {
+		g_autoptr(sqlite3_stmt) stmt = NULL;
+		if (key == NULL) {
+			if (sqlite3_prepare_v2(self->db,
+					       "SELECT key, value FROM quirks WHERE guid = ?1",
+					       -1,
+					       &stmt,
+					       NULL) != SQLITE_OK) {
+				g_warning("failed to prepare SQL: %s", sqlite3_errmsg(self->db));
+				return FALSE;
+			}
+		} else {
+			if (sqlite3_prepare_v2(self->db,
+					       "SELECT key, value FROM quirks WHERE guid = ?1 "
+					       "AND key = ?2",
+					       -1,
+					       &stmt,
+					       NULL) != SQLITE_OK) {
+				g_warning("failed to prepare SQL: %s", sqlite3_errmsg(self->db));
+				return FALSE;
+			}
+			sqlite3_bind_text(stmt, 2, key, -1, SQLITE_STATIC);
+		}
+		for (guint i = 0; i < guids->len; i++) {
+			const gchar *guid = g_ptr_array_index(guids, i);
+			sqlite3_reset(stmt);
+			sqlite3_bind_text(stmt, 1, guid, -1, SQLITE_STATIC);
+			while (sqlite3_step(stmt) == SQLITE_ROW) {
+				const gchar *key_tmp =
+				    (const gchar *)sqlite3_column_text(stmt, 0);
+				const gchar *value = (const gchar *)sqlite3_column_text(stmt, 1);
+				iter_cb(self->ctx,
+					key_tmp,
+					value,
+					FU_CONTEXT_QUIRK_SOURCE_DB,
+					user_data);
+			}
+		}
+	}
+#endif
+
+	/* ensure up to date, once for the whole batch */
+	if (!fu_quirks_check_silo(self, &error)) {
+		g_warning("failed to build silo: %s", error->message);
+		return FALSE;
+	}
+
+	/* no quirk data */
+	if (self->query_vs == NULL) {
+		g_debug("no quirk data");
+		return FALSE;
+	}
+
+	/* query each GUID against the prepared indexes */
+	for (guint i = 0; i < guids->len; i++) {
+		const gchar *guid = g_ptr_array_index(guids, i);
+		g_autoptr(GPtrArray) results = NULL;
+		g_auto(XbQueryContext) context = XB_QUERY_CONTEXT_INIT();
+
+		xb_query_context_set_flags(&context, XB_QUERY_FLAG_USE_INDEXES);
+		xb_value_bindings_bind_str(xb_query_context_get_bindings(&context), 0, guid, NULL);
+		if (key != NULL) {
+			xb_value_bindings_bind_str(xb_query_context_get_bindings(&context),
+						   1,
+						   key,
+						   NULL);
+			results = xb_silo_query_with_context(self->silo,
+							     self->query_kv,
+							     &context,
+							     NULL);
+		} else {
+			results = xb_silo_query_with_context(self->silo,
+							     self->query_vs,
+							     &context,
+							     NULL);
+		}
+		if (results == NULL)
+			continue;
+		for (guint j = 0; j < results->len; j++) {
+			XbNode *n = g_ptr_array_index(results, j);
+			if (self->verbose)
+				g_debug("%s → %s", guid, xb_node_get_text(n));
+			iter_cb(self->ctx,
+				xb_node_get_attr(n, "key"),
+				xb_node_get_text(n),
+				FU_CONTEXT_QUIRK_SOURCE_FILE,
+				user_data);
+		}
+		any_found = TRUE;
+	}
+	return any_found;
+}
+
 #ifdef HAVE_SQLITE
 
 typedef struct {
@@ -1057,8 +1183,13 @@ static void
 fu_quirks_dispose(GObject *object)
 {
 	FuQuirks *self = FU_QUIRKS(object);
-	if (self->ctx != NULL)
+	if (self->ctx != NULL) {
 		g_signal_handlers_disconnect_by_data(self->ctx, self);
+		fu_context_remove_housekeeping_func(
+		    self->ctx,
+		    (FuContextHousekeepingFunc)fu_quirks_housekeeping_cb,
+		    self);
+	}
 	g_clear_object(&self->ctx);
 	G_OBJECT_CLASS(fu_quirks_parent_class)->dispose(object);
 }
@@ -1156,6 +1287,8 @@ fu_quirks_new(FuContext *ctx)
 	FuQuirks *self;
 	self = g_object_new(FU_TYPE_QUIRKS, NULL);
 	self->ctx = g_object_ref(ctx);
-	g_signal_connect(self->ctx, "housekeeping", G_CALLBACK(fu_quirks_housekeeping_cb), self);
+	fu_context_add_housekeeping_func(self->ctx,
+					 (FuContextHousekeepingFunc)fu_quirks_housekeeping_cb,
+					 self);
 	return FU_QUIRKS(self);
 }
@@ -32,14 +32,15 @@ typedef enum {
 
 /**
  * FuQuirksIter:
- * @self: a #FuQuirks
+ * @ctx: a #FuContext
  * @key: a key
  * @value: a value
  * @user_data: (closure): user data
  *
- * The quirks iteration callback.
+ * The quirks iteration callback, compatible with #FuContextLookupIter so that
+ * context callers do not need a re-dispatch trampoline.
  */
-typedef void (*FuQuirksIter)(FuQuirks *self,
+typedef void (*FuQuirksIter)(FuContext *ctx,
 			     const gchar *key,
 			     const gchar *value,
 			     FuContextQuirkSource source,
@@ -60,6 +61,12 @@ fu_quirks_lookup_by_id_iter(FuQuirks *self,
 			    const gchar *key,
 			    FuQuirksIter iter_cb,
 			    gpointer user_data) G_GNUC_NON_NULL(1, 2);
+gboolean
+fu_quirks_lookup_by_id_iter_many(FuQuirks *self,
+				 GPtrArray *guids,
+				 const gchar *key,
+				 FuQuirksIter iter_cb,
+				 gpointer user_data) G_GNUC_NON_NULL(1, 2);
 void
 fu_quirks_add_possible_key(FuQuirks *self, const gchar *possible_key) G_GNUC_NON_NULL(1, 2);
 
@@ -1640,7 +1640,7 @@ typedef struct {
 } FuPluginQuirksAppendHelper;
 
 static void
-fu_plugin_quirks_append_cb(FuQuirks *quirks,
+fu_plugin_quirks_append_cb(FuContext *ctx,
 			   const gchar *key,
 			   const gchar *value,
 			   FuContextQuirkSource source,
@@ -1708,6 +1708,58 @@ fu_plugin_quirks_append_func(void)
 	g_assert_true(helper.seen_two);
 }
 
+typedef struct {
+	guint seen_one;
+	guint seen_two;
+} FuPluginQuirksAppendManyHelper;
+
+static void
+fu_plugin_quirks_append_many_cb(FuContext *ctx,
+				const gchar *key,
+				const gchar *value,
+				FuContextQuirkSource source,
+				gpointer user_data)
+{
+	FuPluginQuirksAppendManyHelper *helper = (FuPluginQuirksAppendManyHelper *)user_data;
+	g_debug("key=%s, value=%s", key, value);
+	if (g_strcmp0(key, "Plugin") == 0 && g_strcmp0(value, "one") == 0) {
+		helper->seen_one++;
+		return;
+	}
+	if (g_strcmp0(key, "Plugin") == 0 && g_strcmp0(value, "two") == 0) {
+		helper->seen_two++;
+		return;
+	}
+	g_assert_not_reached();
+}
+
+static void
+fu_plugin_quirks_append_many_func(void)
+{
+	FuPluginQuirksAppendManyHelper helper = {0};
+	gboolean ret;
+	g_autoptr(FuContext) ctx = fu_context_new();
+	g_autoptr(FuQuirks) quirks = fu_quirks_new(ctx);
+	g_autoptr(GPtrArray) guids = g_ptr_array_new_with_free_func(g_free);
+	g_autoptr(GError) error = NULL;
+
+	/* one GUID matching the duplicate group, and one matching nothing */
+	g_ptr_array_add(guids, g_strdup("b19d1c67-a29a-51ce-9cae-f7b40fe5505b"));
+	g_ptr_array_add(guids, g_strdup("00000000-0000-0000-0000-000000000000"));
+
+	ret = fu_quirks_load(quirks, FU_QUIRKS_LOAD_FLAG_NO_CACHE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	ret = fu_quirks_lookup_by_id_iter_many(quirks,
+					       guids,
+					       NULL,
+					       fu_plugin_quirks_append_many_cb,
+					       &helper);
+	g_assert_true(ret);
+	g_assert_cmpint(helper.seen_one, ==, 1);
+	g_assert_cmpint(helper.seen_two, ==, 1);
+}
+
 static void
 fu_quirks_vendor_ids_func(void)
 {
@@ -7003,6 +7055,7 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/struct{list}", fu_plugin_struct_list_func);
 	g_test_add_func("/fwupd/struct{wrapped}", fu_plugin_struct_wrapped_func);
 	g_test_add_func("/fwupd/plugin{quirks-append}", fu_plugin_quirks_append_func);
+	g_test_add_func("/fwupd/plugin{quirks-append-many}", fu_plugin_quirks_append_many_func);
 	g_test_add_func("/fwupd/quirks{vendor-ids}", fu_quirks_vendor_ids_func);
 	g_test_add_func("/fwupd/string{password-mask}", fu_strpassmask_func);
 	g_test_add_func("/fwupd/string{strsplit-stream}", fu_strsplit_stream_func);
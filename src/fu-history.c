@@ -12,6 +12,7 @@
 #include <json-glib/json-glib.h>
 #include <sqlite3.h>
 
+#include "fu-context-private.h"
 #include "fu-device-private.h"
 #include "fu-history.h"
 #include "fu-release.h"
@@ -1748,8 +1749,13 @@ static void
 fu_history_dispose(GObject *object)
 {
 	FuHistory *self = FU_HISTORY(object);
-	if (self->ctx != NULL)
+	if (self->ctx != NULL) {
 		g_signal_handlers_disconnect_by_data(self->ctx, self);
+		fu_context_remove_housekeeping_func(
+		    self->ctx,
+		    (FuContextHousekeepingFunc)fu_history_housekeeping_cb,
+		    self);
+	}
 	g_clear_object(&self->ctx);
 	G_OBJECT_CLASS(fu_history_parent_class)->dispose(object);
 }
@@ -1789,6 +1795,8 @@ fu_history_new(FuContext *ctx)
 	FuHistory *self;
 	self = g_object_new(FU_TYPE_PENDING, NULL);
 	self->ctx = g_object_ref(ctx);
-	g_signal_connect(self->ctx, "housekeeping", G_CALLBACK(fu_history_housekeeping_cb), self);
+	fu_context_add_housekeeping_func(self->ctx,
+					 (FuContextHousekeepingFunc)fu_history_housekeeping_cb,
+					 self);
 	return FU_HISTORY(self);
 }